@@ -4,33 +4,81 @@
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <memory_resource>
 #include <iostream>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 
 //using namespace std;
 
-template<typename Key, typename Compare>
+template<typename Key, typename Compare, typename Allocator>
 class SetIter;
 
+template<typename Key, std::size_t N, typename Compare>
+class StaticSet;
+
+/**
+ * @struct SetKeyPrefix
+ * Politique de préfixe de clé. Activée, elle fournit un préfixe entier stocké dans chaque nœud : les comparaisons de
+ * find et de l'insertion se font d'abord sur les préfixes, la clé complète n'étant comparée qu'en cas d'égalité.
+ *
+ * Pour l'activer sur ses propres types, il suffit de spécialiser SetKeyPrefix<Key, Compare> avec enabled = true, un
+ * prefix_type entier non signé et une fonction prefix telle que prefix(a) < prefix(b) implique Compare()(a, b).
+ * @tparam Key Type de clé.
+ * @tparam Compare Comparateur du Set : le préfixe doit être cohérent avec lui.
+ */
+template<typename Key, typename Compare>
+struct SetKeyPrefix {
+	static constexpr bool enabled = false;
+	using prefix_type = unsigned char;
+
+	static prefix_type prefix(const Key&) noexcept { return 0; }
+};
+
+/**
+ * Préfixe des chaînes pour std::less : les 8 premiers octets (non signés, comme char_traits<char>::compare), en
+ * big-endian et complétés par des zéros.
+ */
+template<typename Allocator>
+struct SetKeyPrefix<std::basic_string<char, std::char_traits<char>, Allocator>,
+		std::less<std::basic_string<char, std::char_traits<char>, Allocator>>> {
+	static constexpr bool enabled = true;
+	using prefix_type = std::uint64_t;
+
+	static prefix_type prefix(const std::basic_string<char, std::char_traits<char>, Allocator>& key) noexcept {
+		prefix_type p = 0;
+		const std::size_t n = key.size() < sizeof(prefix_type) ? key.size() : sizeof(prefix_type);
+		for (std::size_t i = 0; i < sizeof(prefix_type); ++i)
+			p = (p << 8) | (i < n ? static_cast<unsigned char>(key[i]) : 0u);
+		return p;
+	}
+};
+
 /**
  * @class Set
  * Implémentation par un arbre rouge-noir.
  * @authors Florent Denef (no more Thomas Ducrot since 1st July of 2018).
  * @tparam Key Type de donnée présent dans set
  * @tparam Compare Type de la fonction de comparaison
+ * @tparam Allocator Allocateur de Key, re-lié sur le type de nœud pour toutes les allocations de l'arbre.
  * @version 0.9
- * @todo Destruction de l'objet.
  */
-template<typename Key, typename Compare=std::less<Key>>
+template<typename Key, typename Compare=std::less<Key>, typename Allocator=std::allocator<Key>>
 class Set {
-	friend class SetIter<Key, Compare>;
+	friend class SetIter<Key, Compare, Allocator>;
+	template<typename K, std::size_t N, typename C>
+	friend class StaticSet;
 /**
  * @publicsection Types publics.
  */
 public:
 
 	// Tous les membres de la classe.
-	using iterator =  SetIter<Key, Compare>;
+	using iterator =  SetIter<Key, Compare, Allocator>;
+	using allocator_type = Allocator;
 	using key_type = Key;
 	using value_type = Key;
 	using key_compare = Compare;
@@ -53,53 +101,51 @@ private:
 		noir, rouge
 	};
 
+	using prefix_policy = SetKeyPrefix<Key, Compare>;
+	using prefix_type = typename prefix_policy::prefix_type;
+
+	/**
+	 * Préfixe de clé mis en cache dans le nœud (politique activée).
+	 */
+	struct prefixe_plein {
+		prefix_type prefix{};
+	};
+
+	/**
+	 * Politique désactivée : base vide, aucun surcoût dans le nœud.
+	 */
+	struct prefixe_vide {
+	};
+
 	/**
 	 * @struct node_t
-	 * Structure de nœud pour l'arbre binaire de recherche.
+	 * Structure de nœud pour l'arbre binaire de recherche. La clé est stockée dans le nœud : une seule allocation
+	 * par élément. Elle n'est construite que pour les nœuds de données, jamais pour tnil.
 	 */
-	using node = struct node_t {
+	using node = struct node_t : std::conditional<prefix_policy::enabled, prefixe_plein, prefixe_vide>::type {
 	public:
-		node_t* filsGauche;
-		node_t* filsDroit;
-		node_t* pere;
-		std::unique_ptr<key_type> key;
+		node_t* filsGauche = nullptr;
+		node_t* filsDroit = nullptr;
+		node_t* pere = nullptr;
 		color couleur = noir;
+		bool mort = false; ///< Pierre tombale : nœud effacé logiquement (mode d'effacement paresseux).
+		union {
+			key_type key;
+		};
 
 		/**
-		 * Constructeur par défaut : shared_ptr à nullptr, couleur à noir. Utilisé uniquement par tnil.
+		 * Constructeur par défaut : pointeurs à nullptr, couleur à noir, clé non construite.
 		 */
-		node_t() noexcept = default;
+		node_t() noexcept {}
 
-		/**
-		 * Constructeur le plus utilisé.
-		 * @param [in]key Clé pour le nœud.
-		 * @param [in]pere Le parent du nœud.
-		 * @param [in]couleur Couleur du nœud.
-		 */
-		explicit node_t(reference key, node_t* pere) :
-				key(new key_type(key)), couleur(noir), pere(pere), filsGauche(pere), filsDroit(pere) {}
+		node_t(const node_t&) = delete;
 
-		/**
-		 * Constructeur par copie du nœud.
-		 * @param [in]n Nœud à copier.
-		 */
-		explicit node_t(const node_t& n) :
-				key(n.key), couleur(n.couleur), pere(nullptr), filsGauche(nullptr), filsDroit(nullptr) {}
+		node_t& operator=(const node_t&) = delete;
 
 		/**
-		 * Constructeur par déplacement d'un nœud.
-		 * @param [in]n Nœud à déplacer.
+		 * Destructeur : la clé est détruite par le Set (create_node/destroy_node), pas ici.
 		 */
-		explicit node_t(node_t&& n) noexcept : key(std::move(n.key)), couleur(std::move(n.couleur)),
-											   pere(std::move(n.pere)),
-											   filsGauche(std::move(n.filsGauche)), filsDroit(std::move(n.filsDroit)) {
-			n.filsGauche = n.filsDroit = n.pere = nullptr;
-		}
-
-		/**
-		 * Destructeur (appellera automatiquement les destructeurs des unique_ptr et shared_ptr : garbage collector).
-		 */
-		~node_t() noexcept = default;
+		~node_t() noexcept {}
 
 		/**
 		 * Permet d'avoir le grand-parent du nœud.
@@ -110,43 +156,344 @@ private:
 		}
 	};
 
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	/**
+	 * Alloue un nœud et y construit la clé à partir de args, avec l'allocateur du Set.
+	 * @param [in]args Arguments du constructeur de la clé.
+	 * @return Le nœud, non chaîné.
+	 */
+	template<typename... Args>
+	node* create_node(Args&& ... args) {
+		node* n = node_traits::allocate(this->alloc, 1);
+		node_traits::construct(this->alloc, n);
+		try {
+			node_traits::construct(this->alloc, std::addressof(n->key), std::forward<Args>(args)...);
+		} catch (...) {
+			node_traits::destroy(this->alloc, n);
+			node_traits::deallocate(this->alloc, n, 1);
+			throw;
+		}
+		if constexpr (prefix_policy::enabled)
+			n->prefix = prefix_policy::prefix(n->key);
+		return n;
+	}
+
+	/**
+	 * @return Le préfixe de key selon la politique (valeur quelconque si elle est désactivée).
+	 */
+	static prefix_type key_prefix(const_reference key) noexcept {
+		if constexpr (prefix_policy::enabled)
+			return prefix_policy::prefix(key);
+		else
+			return prefix_type();
+	}
+
+	/**
+	 * @return Le préfixe mis en cache dans n (valeur quelconque si la politique est désactivée).
+	 */
+	static prefix_type node_prefix(const node* n) noexcept {
+		if constexpr (prefix_policy::enabled)
+			return n->prefix;
+		else
+			return prefix_type();
+	}
+
+	/**
+	 * Compare key (de préfixe p) à la clé de x ; la clé de x n'est lue qu'en cas d'égalité des préfixes.
+	 * @return key < x->key
+	 */
+	bool key_less(const_reference key, prefix_type p, const node* x) {
+		if constexpr (prefix_policy::enabled) {
+			if (p != x->prefix)
+				return p < x->prefix;
+		}
+		return keyComp(key, x->key);
+	}
+
+	/**
+	 * @return x->key < key, avec p le préfixe de key.
+	 */
+	bool node_less(const node* x, const_reference key, prefix_type p) {
+		if constexpr (prefix_policy::enabled) {
+			if (x->prefix != p)
+				return x->prefix < p;
+		}
+		return keyComp(x->key, key);
+	}
+
+	/**
+	 * Détruit la clé d'un nœud de données et libère le nœud.
+	 * @param [in]n Nœud à libérer, différent de tnil.
+	 */
+	void destroy_node(node* n) noexcept {
+		node_traits::destroy(this->alloc, std::addressof(n->key));
+		node_traits::destroy(this->alloc, n);
+		node_traits::deallocate(this->alloc, n, 1);
+	}
+
+	/**
+	 * @return Une sentinelle tnil allouée avec l'allocateur du Set.
+	 */
+	node* create_nil() {
+		node* n = node_traits::allocate(this->alloc, 1);
+		node_traits::construct(this->alloc, n);
+		return n;
+	}
+
+	/**
+	 * Recrée la sentinelle si le Set n'en a plus (déplacé ou après destroy_nil) : arbre vide, racine et extrêmes
+	 * pointant sur tnil. Les lectures d'un Set sans sentinelle n'en ont pas besoin : racine == plusPetit == tnil.
+	 */
+	void restore_nil() {
+		if (this->tnil == nullptr)
+			this->racine = this->plusPetit = this->plusGrand = this->tnil = create_nil();
+	}
+
+	/**
+	 * Libère la sentinelle tnil (s'il y en a une : un Set déplacé n'en a plus).
+	 */
+	void destroy_nil() noexcept {
+		if (this->tnil != nullptr) {
+			node_traits::destroy(this->alloc, this->tnil);
+			node_traits::deallocate(this->alloc, this->tnil, 1);
+			this->tnil = this->racine = this->plusPetit = this->plusGrand = nullptr;
+		}
+	}
+
+	/**
+	 * Par défaut, la mémoire d'un allocateur doit être rendue nœud par nœud.
+	 */
+	template<typename A>
+	static bool monotonic(const A&) noexcept { return false; }
+
+	/**
+	 * Une ressource monotone ne libère rien avant sa propre destruction : deallocate est sans effet.
+	 */
+	template<typename T>
+	static bool monotonic(const std::pmr::polymorphic_allocator<T>& a) noexcept {
+		return dynamic_cast<std::pmr::monotonic_buffer_resource*>(a.resource()) != nullptr;
+	}
+
+	/**
+	 * @return True si clear() et le destructeur peuvent abandonner les nœuds sans les parcourir : clés trivialement
+	 * destructibles et allocateur adossé à une std::pmr::monotonic_buffer_resource.
+	 */
+	bool deallocation_inutile() const noexcept {
+		return std::is_trivially_destructible<key_type>::value && monotonic(this->alloc);
+	}
+
+	/**
+	 * Libère récursivement (post-ordre) le sous-arbre de racine x.
+	 * @param [in]x Racine du sous-arbre.
+	 */
+	void destroy_tree(node* x) noexcept {
+		while (x != this->tnil) {
+			destroy_tree(x->filsDroit);
+			node* gauche = x->filsGauche;
+			destroy_node(x);
+			x = gauche;
+		}
+	}
+
+	/**
+	 * Copie, en O(n), les éléments vivants de s dans *this supposé vide : les nœuds sont alloués dans l'ordre infixe
+	 * puis chaînés par rebuild.
+	 * @param [in]s Set à copier.
+	 */
+	void copy_from(const Set& s) {
+		if (s.size == 0)
+			return;
+		std::vector<node*> nodes;
+		nodes.reserve(s.size);
+		try {
+			for (node* x = s.next_live(s.plusPetit); x != s.tnil; x = s.next_live(s.tree_successor(x)))
+				nodes.push_back(create_node(static_cast<const_reference>(x->key)));
+		} catch (...) {
+			for (node* n : nodes)
+				destroy_node(n);
+			throw;
+		}
+		rebuild(nodes);
+	}
+
+	/**
+	 * Vole l'arbre de x (allocateurs égaux ou propagés) ; x récupère l'ancienne sentinelle de *this, vide.
+	 * @param [in]x Set dont on prend les nœuds.
+	 */
+	void steal(Set& x) noexcept {
+		std::swap(this->tnil, x.tnil);
+		std::swap(this->racine, x.racine);
+		std::swap(this->plusPetit, x.plusPetit);
+		std::swap(this->plusGrand, x.plusGrand);
+		std::swap(this->size, x.size);
+		std::swap(this->morts, x.morts);
+		std::swap(this->effacementParesseux, x.effacementParesseux);
+		std::swap(this->seuilCompaction, x.seuilCompaction);
+		std::swap(this->keyComp, x.keyComp);
+		std::swap(this->valueComp, x.valueComp);
+	}
+
+	/**
+	 * Déplace une à une les clés vivantes de x dans des nœuds alloués par *this (allocateurs différents) ; x est
+	 * ensuite vidé.
+	 * @param [in]x Set source.
+	 */
+	void move_elements(Set& x) {
+		this->effacementParesseux = x.effacementParesseux;
+		this->seuilCompaction = x.seuilCompaction;
+		if (x.tnil == nullptr)
+			return;
+		std::vector<node*> nodes;
+		nodes.reserve(x.size);
+		try {
+			for (node* n = x.next_live(x.plusPetit); n != x.tnil; n = x.next_live(x.tree_successor(n)))
+				nodes.push_back(create_node(std::move(n->key)));
+		} catch (...) {
+			for (node* n : nodes)
+				destroy_node(n);
+			throw;
+		}
+		rebuild(nodes);
+		x.clear();
+	}
+
 	/**
 	 * Permet de rechercher le minimum (si Compare = std::less) ou le maximum (Compare = std::greater)
 	 * @param [in]x La racine du sous-arbre dont on doit trouver le "minimum"
 	 * @return Le "minimum" de l'arbre
 	 */
-	node* tree_minimum(node* x) {
+	node* tree_minimum(node* x) const {
 		while (x->filsGauche != this->tnil)
 			x = x->filsGauche;
 		return x;
 	}
 
-	node* tree_maximum(node* x) {
+	node* tree_maximum(node* x) const {
 		while (x->filsDroit != this->tnil)
 			x = x->filsDroit;
 		return x;
 	}
 
+	/**
+	 * Prédécesseur d'un nœud dans le parcours infixe.
+	 * @param [in]x Nœud dont on cherche le prédécesseur.
+	 * @return Le prédécesseur de x, ou tnil si x est le "minimum".
+	 */
+	node* tree_predecessor(node* x) const {
+		if (x->filsGauche != this->tnil)
+			return tree_maximum(x->filsGauche);
+		node* y = x->pere;
+		while (y != this->tnil && x == y->filsGauche) {
+			x = y;
+			y = y->pere;
+		}
+		return y;
+	}
+
+	/**
+	 * Successeur d'un nœud dans le parcours infixe.
+	 * @param [in]x Nœud dont on cherche le successeur.
+	 * @return Le successeur de x, ou tnil si x est le "maximum".
+	 */
+	node* tree_successor(node* x) const {
+		if (x->filsDroit != this->tnil)
+			return tree_minimum(x->filsDroit);
+		node* y = x->pere;
+		while (y != this->tnil && x == y->filsDroit) {
+			x = y;
+			y = y->pere;
+		}
+		return y;
+	}
+
+	/**
+	 * Premier nœud vivant à partir de x (x compris) dans le parcours infixe.
+	 * @param [in]x Nœud de départ.
+	 * @return Le premier nœud non marqué comme mort, ou tnil.
+	 */
+	node* next_live(node* x) const {
+		while (x != this->tnil && x->mort)
+			x = tree_successor(x);
+		return x;
+	}
+
+	/**
+	 * Ressuscite une pierre tombale : l'élément effacé n'existant plus, le nœud reçoit la nouvelle valeur (qui peut
+	 * différer de l'ancienne tout en lui étant équivalente pour le comparateur), comme en mode non paresseux.
+	 * @param [in]n Nœud mort portant une clé équivalente à value.
+	 * @param [in]value Valeur à stocker.
+	 */
+	template<typename V>
+	void revive(node* n, V&& value) {
+		n->key = std::forward<V>(value);
+		if constexpr (prefix_policy::enabled)
+			n->prefix = prefix_policy::prefix(n->key);
+		n->mort = false;
+		--this->morts;
+		++this->size;
+	}
+
+	/**
+	 * Premier nœud vivant à partir de x (x compris) dans le parcours infixe inverse.
+	 * @param [in]x Nœud de départ.
+	 * @return Le premier nœud non marqué comme mort, ou tnil.
+	 */
+	node* prev_live(node* x) const {
+		while (x != this->tnil && x->mort)
+			x = tree_predecessor(x);
+		return x;
+	}
+
+	/**
+	 * Recherche du nœud portant la clé, qu'il soit vivant ou mort.
+	 * @param [in]key Clé à trouver.
+	 * @return Le nœud, ou tnil si la clé n'est pas dans l'arbre.
+	 */
+	node* find_node(const_reference key) {
+		const prefix_type p = key_prefix(key);
+		node* x = this->racine;
+		while (x != this->tnil) {
+			if (key_less(key, p, x))
+				x = x->filsGauche;
+			else if (node_less(x, key, p))
+				x = x->filsDroit;
+			else
+				break;
+		}
+		return x;
+	}
+
 	/**
 	 * Insertion du nœud dans l'arbre, algorithme prit dans le livre <a href="https://fr.wikipedia.org/wiki/Introduction_%C3%A0_l%27algorithmique">"Introduction to algorithm, third edition".</a>
+	 * Met aussi à jour plusPetit/plusGrand : z les remplace s'il est accroché à gauche de l'un ou à droite de l'autre.
 	 * @param [in]z nœud à insérer.
 	 */
 	void insert_rd_tree(node* z) {
 		node* x(this->racine), * y(this->tnil);
+		const prefix_type p = node_prefix(z);
+		bool gauche = false;
 		while (x != this->tnil) {
 			y = x;
-			if (keyComp(*z->key, *x->key))
+			gauche = key_less(z->key, p, x);
+			if (gauche)
 				x = x->filsGauche;
 			else
 				x = x->filsDroit;
 		}
 		z->pere = y;
-		if (y == this->tnil)
-			this->racine = z;
-		else if (keyComp(*z->key, *y->key))
+		if (y == this->tnil) {
+			this->racine = this->plusPetit = this->plusGrand = z;
+		} else if (gauche) {
 			y->filsGauche = z;
-		else
+			if (y == this->plusPetit)
+				this->plusPetit = z;
+		} else {
 			y->filsDroit = z;
+			if (y == this->plusGrand)
+				this->plusGrand = z;
+		}
 		z->filsGauche = this->tnil;
 		z->filsDroit = this->tnil;
 		z->couleur = rouge;
@@ -321,11 +668,97 @@ private:
 		x->couleur = noir;
 	}
 
+	/**
+	 * Retire physiquement le nœud z de l'arbre et le libère (algorithme RB-DELETE du livre).
+	 * Les autres nœuds ne sont que ré-chaînés : les pointeurs vers eux restent valides.
+	 * @param [in]z Nœud à effacer, différent de tnil.
+	 */
+	void erase_node(node* z) {
+		if (z == this->plusPetit)
+			this->plusPetit = tree_successor(z);
+		if (z == this->plusGrand)
+			this->plusGrand = tree_predecessor(z);
+		node* y(z), * x;
+		color y_original = y->couleur;
+		if (z->filsGauche == this->tnil) {
+			x = z->filsDroit;
+			rb_transplant(z, z->filsDroit);
+		} else if (z->filsDroit == this->tnil) {
+			x = z->filsGauche;
+			rb_transplant(z, z->filsGauche);
+		} else {
+			y = tree_minimum(z->filsDroit);
+			y_original = y->couleur;
+			x = y->filsDroit;
+			if (y->pere == z)
+				x->pere = y;
+			else {
+				rb_transplant(y, y->filsDroit);
+				y->filsDroit = z->filsDroit;
+				y->filsDroit->pere = y;
+			}
+			rb_transplant(z, y);
+			y->filsGauche = z->filsGauche;
+			y->filsGauche->pere = y;
+			y->couleur = z->couleur;
+		}
+		if (y_original == noir)
+			rb_delete_fixup(x);
+		if (z->mort)
+			--this->morts;
+		else
+			--this->size;
+		destroy_node(z);
+	}
+
+	/**
+	 * Reconstruit l'arbre à partir de nœuds déjà triés, en O(n). L'arbre obtenu est de hauteur minimale : tous les
+	 * niveaux sont pleins sauf éventuellement le dernier, dont les nœuds sont colorés en rouge, les autres en noir.
+	 * @param [in]nodes Nœuds à réutiliser, dans l'ordre infixe.
+	 */
+	void rebuild(std::vector<node*>& nodes) {
+		this->size = nodes.size();
+		this->morts = 0;
+		size_type hauteurNoire = 0;
+		for (size_type n = this->size + 1; n > 1; n >>= 1)
+			++hauteurNoire;
+		this->racine = build_balanced(nodes.data(), nodes.data() + nodes.size(), this->tnil, 0, hauteurNoire);
+		this->plusPetit = nodes.empty() ? this->tnil : nodes.front();
+		this->plusGrand = nodes.empty() ? this->tnil : nodes.back();
+	}
+
+	/**
+	 * Construit récursivement un sous-arbre équilibré sur [first, last) en prenant le milieu comme racine.
+	 * @param [in]first Premier nœud.
+	 * @param [in]last Après le dernier nœud.
+	 * @param [in]pere Parent du sous-arbre.
+	 * @param [in]profondeur Profondeur de la racine du sous-arbre.
+	 * @param [in]hauteurNoire Profondeur à partir de laquelle les nœuds sont rouges.
+	 * @return La racine du sous-arbre, ou tnil s'il est vide.
+	 */
+	node* build_balanced(node** first, node** last, node* pere, size_type profondeur, size_type hauteurNoire) {
+		if (first == last)
+			return this->tnil;
+		node** milieu = first + (last - first) / 2;
+		node* x = *milieu;
+		x->pere = pere;
+		x->couleur = profondeur >= hauteurNoire ? rouge : noir;
+		x->filsGauche = build_balanced(first, milieu, x, profondeur + 1, hauteurNoire);
+		x->filsDroit = build_balanced(milieu + 1, last, x, profondeur + 1, hauteurNoire);
+		return x;
+	}
+
+	node_allocator alloc;
 	key_compare keyComp;
 	value_compare valueComp;
 	node* tnil;
 	node* racine;
+	node* plusPetit; ///< Nœud le plus à gauche (tnil si vide), maintenu par l'insertion et l'effacement.
+	node* plusGrand; ///< Nœud le plus à droite (tnil si vide).
 	size_type size;
+	size_type morts = 0; ///< Nombre de pierres tombales encore présentes dans l'arbre.
+	bool effacementParesseux = false;
+	double seuilCompaction = 0.5; ///< Proportion de nœuds morts au-delà de laquelle l'arbre est compacté.
 /**
  * @publicsection
  */
@@ -333,13 +766,22 @@ public:
 	/**
 	 * Constructeur par défaut.
 	 */
-	Set() : tnil(new node()), racine(tnil), size(0) {}
+	Set() : Set(key_compare()) {}
 
 	/**
 	 * Crée un set vide avec le comp correspondant.
 	 * @param [in]comp
+	 * @param [in]a Allocateur (par exemple un std::pmr::polymorphic_allocator sur une ressource locale).
 	 */
-	explicit Set(const key_compare& comp) : keyComp(comp), valueComp(comp) {}
+	explicit Set(const key_compare& comp, const allocator_type& a = allocator_type()) :
+			alloc(a), keyComp(comp), valueComp(comp), tnil(create_nil()), racine(tnil), plusPetit(tnil),
+			plusGrand(tnil), size(0) {}
+
+	/**
+	 * Crée un set vide utilisant l'allocateur a.
+	 * @param [in]a Allocateur.
+	 */
+	explicit Set(const allocator_type& a) : Set(key_compare(), a) {}
 
 	/**
 	 * Construit un set avec le nombre d'élément compris entre [first, last) avec chaque élément construit emplace
@@ -348,56 +790,102 @@ public:
 	 * @param [in]first
 	 * @param [in]last
 	 * @param [in]comp
+	 * @param [in]a
 	 */
 	template<typename InputIterator>
-	Set(InputIterator first, InputIterator last, key_compare& comp = key_compare()) : keyComp(comp), valueComp(comp) {
-
+	Set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+		const allocator_type& a = allocator_type()) : Set(comp, a) {
+		this->insert(first, last);
 	}
 
 	/**
-	 * Constructeur par copie.
+	 * Constructeur par copie. L'allocateur est obtenu par select_on_container_copy_construction.
 	 * @param [in]s Set compatible à copier.
 	 */
-	Set(const Set& s) : size(s.size), keyComp(s.keyComp), valueComp(s.valueComp) {
-		for (auto&& item : s) {
-			this->insert(item);
-		}
+	Set(const Set& s) : Set(s, std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+			allocator_type(s.alloc))) {}
+
+	/**
+	 * Constructeur par copie avec un allocateur explicite.
+	 * @param [in]s Set compatible à copier.
+	 * @param [in]a Allocateur du nouveau Set.
+	 */
+	Set(const Set& s, const allocator_type& a) : Set(s.keyComp, a) {
+		this->effacementParesseux = s.effacementParesseux;
+		this->seuilCompaction = s.seuilCompaction;
+		copy_from(s);
 	}
 
 	/**
-	 * Constructeur par déplacement
+	 * Constructeur par déplacement : l'allocateur est déplacé avec les nœuds. Le Set déplacé reste un Set vide valide :
+	 * sans sentinelle (racine == tnil == nullptr), il la recrée à la première insertion ou affectation.
 	 * @param [in]s Set à déplacer (voler) les données
 	 */
-	Set(Set&& s) noexcept : size(std::move(s.size)), racine(std::move(s.racine)), tnil(std::move(s.tnil)),
-							keyComp(std::move(s.keyComp)),
-							valueComp(std::move(s.valueComp)) {
-		s.keyComp = s.valueComp = s.racine = s.tnil = nullptr;
+	Set(Set&& s) noexcept : alloc(std::move(s.alloc)), keyComp(s.keyComp), valueComp(s.valueComp), tnil(s.tnil),
+							racine(s.racine), plusPetit(s.plusPetit), plusGrand(s.plusGrand), size(s.size),
+							morts(s.morts), effacementParesseux(s.effacementParesseux),
+							seuilCompaction(s.seuilCompaction) {
+		s.tnil = s.racine = s.plusPetit = s.plusGrand = nullptr;
+		s.size = s.morts = 0;
+	}
+
+	/**
+	 * Constructeur par déplacement avec un allocateur explicite : les nœuds ne sont volés que si les allocateurs
+	 * sont égaux, sinon les clés sont déplacées une à une.
+	 * @param [in]s Set à déplacer.
+	 * @param [in]a Allocateur du nouveau Set.
+	 */
+	Set(Set&& s, const allocator_type& a) : Set(s.keyComp, a) {
+		if (this->alloc == s.alloc)
+			steal(s);
+		else
+			move_elements(s);
 	}
 
 	/**
 	 * Constructeur par liste d'initialisation
 	 * @param [in] il liste d'initialisation
 	 * @param [in]comp comparateur
+	 * @param [in]a allocateur
 	 */
-	Set(std::initializer_list<value_type> il, const key_compare& comp = key_compare()) : keyComp(comp),
-																						 valueComp(comp) {
+	Set(std::initializer_list<value_type> il, const key_compare& comp = key_compare(),
+		const allocator_type& a = allocator_type()) : Set(comp, a) {
 		for (auto&& item : il) {
 			this->insert(item);
 		}
 	}
 
 	/**
-	 * Détruis l'objet.
+	 * Détruis l'objet. O(1) si deallocation_inutile().
 	 */
 	~Set() noexcept {
+		clear();
+		destroy_nil();
+	}
 
+	/**
+	 * Efface tous les éléments. Avec des clés trivialement destructibles et une
+	 * std::pmr::monotonic_buffer_resource, les nœuds sont abandonnés à la ressource : O(1).
+	 */
+	void clear() noexcept {
+		if (this->tnil == nullptr)
+			return;
+		if (!deallocation_inutile())
+			destroy_tree(this->racine);
+		this->racine = this->plusPetit = this->plusGrand = this->tnil;
+		this->size = this->morts = 0;
 	}
 
+	/**
+	 * @return [out] Une copie de l'allocateur.
+	 */
+	allocator_type get_allocator() const noexcept { return allocator_type(this->alloc); }
+
 	/**
 	 * Itérateur de début du Set.
 	 * @return retourne un itérateur sur le début du Set.
 	 */
-	iterator begin() noexcept { return iterator(*this, tree_minimum(this->racine)); }
+	iterator begin() noexcept { return iterator(*this, next_live(this->plusPetit)); }
 
 	/**
 	 * Itérateur de fin du Set.
@@ -405,6 +893,38 @@ public:
 	 */
 	iterator end() noexcept { return iterator(*this, this->tnil); }
 
+	/**
+	 * Plus petit élément, en O(1) (hors pierres tombales). Le Set ne doit pas être vide.
+	 * @return [out] Référence constante sur le premier élément.
+	 */
+	const_reference front() const { return next_live(this->plusPetit)->key; }
+
+	/**
+	 * Plus grand élément, en O(1) (hors pierres tombales). Le Set ne doit pas être vide.
+	 * @return [out] Référence constante sur le dernier élément.
+	 */
+	const_reference back() const { return prev_live(this->plusGrand)->key; }
+
+	/**
+	 * Efface le plus petit élément sans recherche depuis la racine. Les pierres tombales rencontrées en tête sont
+	 * retirées au passage. Le Set ne doit pas être vide.
+	 */
+	void pop_front() {
+		while (this->plusPetit->mort)
+			erase_node(this->plusPetit);
+		erase_node(this->plusPetit);
+	}
+
+	/**
+	 * Efface le plus grand élément sans recherche depuis la racine. Les pierres tombales rencontrées en queue sont
+	 * retirées au passage. Le Set ne doit pas être vide.
+	 */
+	void pop_back() {
+		while (this->plusGrand->mort)
+			erase_node(this->plusGrand);
+		erase_node(this->plusGrand);
+	}
+
 	/**
 	 * Vérifie si le conteneur est vide.
 	 * @return [out] True si il est vide.
@@ -424,15 +944,9 @@ public:
 	 * @param [in]key Clé à trouver.
 	 * @return [out] Normalement retourne un itérateur sur l'élément
 	 */
-	iterator find(const reference key) {
-		node* x = this->racine;
-		while (x != this->tnil && ((keyComp(key, *x->key) || keyComp(*x->key, key)))) {
-			if (keyComp(key, *x->key))
-				x = x->filsGauche;
-			else
-				x = x->filsDroit;
-		}
-		return iterator(*this, x);
+	iterator find(const_reference key) {
+		node* x = find_node(key);
+		return iterator(*this, x != this->tnil && x->mort ? this->tnil : x);
 	}
 
 	/**
@@ -440,13 +954,17 @@ public:
 	 * @param [in]value
 	 * @return [out]Une paire avec l'itérateur sur le nœud et un booléen si l'opération a réussi ou non.
 	 */
-	std::pair<iterator, bool> insert(const reference value) {
-		if (find(value).currentNode != this->tnil) {
-			return std::pair<iterator, bool>(iterator(*this), false);
+	std::pair<iterator, bool> insert(const_reference value) {
+		restore_nil();
+		node* n = find_node(value);
+		if (n != this->tnil) {
+			if (!n->mort)
+				return std::pair<iterator, bool>(iterator(*this), false);
+			revive(n, value);
+			return std::pair<iterator, bool>(iterator(*this, n), true);
 		}
-		node* n;
 		try {
-			n = new node(value, this->tnil);//Peut throw bad_alloc
+			n = create_node(value);//Peut throw bad_alloc
 		} catch (const std::exception& e) {
 			std::cerr << e.what() << std::endl;
 			return std::pair<iterator, bool>(iterator(*this), false);
@@ -462,12 +980,16 @@ public:
 	 * @return [out] Une pair avec first = iterator, second = true/false.
 	 */
 	std::pair<iterator, bool> insert(value_type&& value) {
-		if (find(value).currentNode != this->tnil) {
-			return std::pair<iterator, bool>(iterator(*this), false);
+		restore_nil();
+		node* n = find_node(value);
+		if (n != this->tnil) {
+			if (!n->mort)
+				return std::pair<iterator, bool>(iterator(*this), false);
+			revive(n, std::move(value));
+			return std::pair<iterator, bool>(iterator(*this, n), true);
 		}
-		node* n;
 		try {
-			n = new node(value, this->tnil);//Peut throw bad_alloc
+			n = create_node(std::move(value));//Peut throw bad_alloc
 		} catch (const std::exception& e) {
 			std::cerr << e.what() << std::endl;
 			return std::pair<iterator, bool>(iterator(*this), false);
@@ -501,45 +1023,121 @@ public:
 	}
 
 	/**
-	 * Permets d'effacer un noeud de l'arbre.
+	 * Permets d'effacer un noeud de l'arbre. En mode paresseux, le nœud est seulement marqué comme mort ; l'arbre est
+	 * compacté dès que la proportion de nœuds morts dépasse le seuil de compaction.
 	 * @param [in]key Valeur contenue dans le noeud à effacer.
 	 * @return [out] Nombre d'élément d'enlever (ici 0 ou 1, chaque élément étant unique).
-	 * @todo Finir cette méthode ainsi que les fonctions qui lui sont nécessaires.
 	 */
-	size_type erase(const reference key) {
-		node* z(find(key).currentNode), * y(z), * x;
-		if (z != this->tnil) {
+	size_type erase(const_reference key) {
+		node* z(find_node(key));
+		if (z == this->tnil || z->mort) {
 			return 0;
 		}
-		color y_original = y->couleur;
-		if (z->filsGauche == this->tnil) {
-			x = z->filsDroit;
-			rb_transplant(z, z->filsDroit);
-		} else if (z->filsDroit == this->tnil) {
-			x = z->filsGauche;
-			rb_transplant(z, z->filsGauche);
+		if (this->effacementParesseux) {
+			z->mort = true;
+			--this->size;
+			++this->morts;
+			if (static_cast<double>(this->morts) > this->seuilCompaction * static_cast<double>(this->size + this->morts))
+				compact();
 		} else {
-			y = tree_minimum(z->filsDroit);
-			y_original = y->couleur;
-			x = y->filsDroit;
-			if (y->pere == z)
-				x->pere = y;
-			else {
-				rb_transplant(y, y->filsDroit);
-				y->filsDroit = z->filsDroit;
-				y->filsDroit->pere = y;
-			}
-			rb_transplant(z, y);
-			y->filsGauche = z->filsGauche;
-			y->filsGauche->pere = y;
-			y->couleur = z->couleur;
+			erase_node(z);
 		}
-		if (y_original == noir)
-			rb_delete_fixup(x);
-		--this->size;
 		return 1; //Si élément présent
 	}
 
+	/**
+	 * Retire physiquement tous les nœuds morts en une seule reconstruction O(n) de l'arbre.
+	 */
+	void compact() {
+		if (this->morts == 0)
+			return;
+		std::vector<node*> vivants, tombes;
+		vivants.reserve(this->size);
+		tombes.reserve(this->morts);
+		for (node* x = this->plusPetit; x != this->tnil; x = tree_successor(x))
+			(x->mort ? tombes : vivants).push_back(x);
+		for (node* z : tombes)
+			destroy_node(z);
+		rebuild(vivants);
+	}
+
+	/**
+	 * Active ou désactive l'effacement paresseux. La désactivation compacte l'arbre.
+	 * @param [in]actif True pour que erase ne fasse que marquer les nœuds.
+	 */
+	void setLazyErase(bool actif) {
+		this->effacementParesseux = actif;
+		if (!actif)
+			compact();
+	}
+
+	/**
+	 * @return [out] True si l'effacement paresseux est actif.
+	 */
+	bool isLazyErase() const noexcept { return this->effacementParesseux; }
+
+	/**
+	 * Modifie la proportion de nœuds morts qui déclenche une compaction automatique.
+	 * @param [in]seuil Proportion dans [0, 1] ; 1 désactive la compaction automatique.
+	 */
+	void setCompactionThreshold(double seuil) noexcept { this->seuilCompaction = seuil; }
+
+	/**
+	 * @return [out] Nombre d'éléments vivants (identique à getSize()).
+	 */
+	size_type getLiveCount() const noexcept { return this->size; }
+
+	/**
+	 * @return [out] Nombre de pierres tombales présentes dans l'arbre.
+	 */
+	size_type getDeadCount() const noexcept { return this->morts; }
+
+	/**
+	 * @return [out] Proportion de nœuds morts parmi tous les nœuds de l'arbre.
+	 */
+	double getDeadRatio() const noexcept {
+		return this->morts == 0 ? 0.0 : static_cast<double>(this->morts) / static_cast<double>(this->size + this->morts);
+	}
+
+	/**
+	 * Efface tous les éléments pour lesquels pred renvoie true. Le prédicat est appelé une seule fois par élément vivant,
+	 * dans l'ordre du parcours infixe ; les pierres tombales sont retirées au passage.
+	 *
+	 * La stratégie dépend de la proportion d'éléments retirés : si k suppressions coûtent moins qu'un parcours
+	 * (k * log2(n) < n), chaque nœud est effacé en place. Sinon, l'arbre est reconstruit en O(n) à partir des nœuds
+	 * survivants (réutilisés tels quels), parfaitement équilibré et recoloré.
+	 * @tparam Predicate Prédicat unaire sur const_reference.
+	 * @param [in]pred Prédicat de suppression.
+	 * @return [out] Nombre d'éléments effacés.
+	 */
+	template<typename Predicate>
+	size_type erase_if(Predicate pred) {
+		std::vector<node*> survivants, condamnes;
+		survivants.reserve(this->size);
+		for (node* x = this->plusPetit; x != this->tnil; x = tree_successor(x)) {
+			if (x->mort || pred(static_cast<const_reference>(x->key)))
+				condamnes.push_back(x);
+			else
+				survivants.push_back(x);
+		}
+		const size_type k = condamnes.size() - this->morts;
+		if (condamnes.empty())
+			return 0;
+		const size_type total = this->size + this->morts;
+		size_type profondeur = 0;
+		for (size_type n = total; n != 0; n >>= 1)
+			++profondeur;
+		if (condamnes.size() * profondeur < total) {
+			for (node* z : condamnes)
+				erase_node(z);
+		} else {
+			for (node* z : condamnes)
+				destroy_node(z);
+			rebuild(survivants);
+		}
+		return k;
+	}
+
 	/**
 	 * Renvoie la fonction de comparaison des clés.
 	 * @return [out] Fonction de comparaison de l'objet courant.
@@ -553,32 +1151,52 @@ public:
 	inline value_compare value_comp() const { return valueComp; }
 
 	/**
-	 * Assignation par copie. Utilisation de l'itérateur.
+	 * Assignation par copie. L'allocateur de x est repris si propagate_on_container_copy_assignment.
 	 * @param [in]x Objet à copier.
 	 * @return [out] L'objet copié
 	 */
 	Set& operator=(const Set& x) {
 		if (this != &x) {
-			for (auto&& item : x) {
-				this->insert(item);
+			clear();
+			if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+				if (this->alloc != x.alloc) {
+					destroy_nil();
+					this->alloc = x.alloc;
+				}
 			}
+			restore_nil();
+			this->keyComp = x.keyComp;
+			this->valueComp = x.valueComp;
+			this->effacementParesseux = x.effacementParesseux;
+			this->seuilCompaction = x.seuilCompaction;
+			copy_from(x);
 		}
 		return *this;
 	}
 
 	/**
-	 * Assignation par déplacement.
+	 * Assignation par déplacement. Les nœuds sont volés si l'allocateur se propage
+	 * (propagate_on_container_move_assignment) ou si les deux allocateurs sont égaux ; sinon les clés sont déplacées
+	 * une à une dans des nœuds alloués par *this.
 	 * @param [in]x Objet dont on déplace les ressources.
 	 * @return [out] L'objet nouvellement créé.
 	 */
-	Set& operator=(Set&& x) noexcept {
+	Set& operator=(Set&& x) noexcept(node_traits::propagate_on_container_move_assignment::value ||
+									 node_traits::is_always_equal::value) {
 		if (this != &x) {
-			size = std::move(x.size);
-			racine = std::move(x.racine);
-			tnil = std::move(x.tnil);
-			keyComp = std::move(x.keyComp);
-			valueComp = std::move(x.valueComp);
-			x.tnil = x.racine = x.valueComp = x.keyComp = nullptr;
+			clear();
+			if (this->alloc == x.alloc) {
+				steal(x);
+			} else if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+				destroy_nil();
+				this->alloc = std::move(x.alloc);
+				steal(x);
+			} else {
+				restore_nil();
+				this->keyComp = x.keyComp;
+				this->valueComp = x.valueComp;
+				move_elements(x);
+			}
 		}
 		return *this;
 	}
@@ -601,7 +1219,7 @@ public:
 	 * @param [in]rhs Set à comparer avec *this
 	 * @return [out]True : les deux sont égaux
 	 */
-	bool operator==(const Set<Key, Compare>& rhs) {
+	bool operator==(const Set& rhs) {
 		if (this->size != rhs.size)
 			return false;
 
@@ -609,15 +1227,24 @@ public:
 	}
 
 	/**
-	 * Spécialise l'algorithme std::swap.
+	 * Spécialise l'algorithme std::swap. Les allocateurs sont échangés si propagate_on_container_swap ; sinon, s'ils
+	 * sont égaux, seuls les arbres sont échangés. Avec des allocateurs différents qui ne se propagent pas, les
+	 * contenus sont recopiés dans l'allocateur de l'autre Set (chacun garde son allocateur).
 	 * @param other Set compatible dont on peut swap les attributs.
 	 */
 	void swap(Set& other) {
-		std::swap(this->size, other.size);
-		std::swap(this->tnil, other.tnil);
-		std::swap(this->racine, other.racine);
-		std::swap(this->keyComp, other.keyComp);
-		std::swap(this->valueComp, other.valueComp);
+		if constexpr (node_traits::propagate_on_container_swap::value) {
+			using std::swap;
+			swap(this->alloc, other.alloc);
+			steal(other);
+		} else if (this->alloc == other.alloc) {
+			steal(other);
+		} else {
+			Set pourThis(other, allocator_type(this->alloc));
+			Set pourOther(*this, allocator_type(other.alloc));
+			*this = std::move(pourThis);
+			other = std::move(pourOther);
+		}
 	}
 };
 
@@ -626,19 +1253,20 @@ public:
  * @authors Florent Denef (no more Thomas Ducrot since 1st July 2018)
  * @tparam [in]Key type de clé
  * @tparam [in]Compare foncteur de comparaison
- * @todo L'opérateur d'avancée (++)
+ * @tparam [in]Allocator allocateur du Set
+ * @todo L'opérateur d'avancée postfixe (++)
  */
-template<typename Key, typename Compare>
+template<typename Key, typename Compare, typename Allocator>
 class SetIter {
-	friend class Set<Key, Compare>;
+	friend class Set<Key, Compare, Allocator>;
 /**
  * @privatesection
  */
 private:
-	Set<Key, Compare>& myset;
+	Set<Key, Compare, Allocator>& myset;
 	size_t size{};
-	typename Set<Key, Compare>::node* currentNode;
-	typename Set<Key, Compare>::node* lastNode;
+	typename Set<Key, Compare, Allocator>::node* currentNode;
+	typename Set<Key, Compare, Allocator>::node* lastNode;
 
 /**
  * @publicsection
@@ -648,8 +1276,8 @@ public:
 	 *Constructeur par "défaut"
 	 * @param [in]myset
 	 */
-	explicit SetIter(Set<Key, Compare>& myset) : myset(myset), currentNode(myset.racine),
-												 size(myset.getSize()) {
+	explicit SetIter(Set<Key, Compare, Allocator>& myset) : myset(myset), currentNode(myset.racine),
+															size(myset.getSize()) {
 		if (currentNode != myset.tnil) {
 			this->lastNode = currentNode->pere;
 		}
@@ -660,9 +1288,8 @@ public:
 	 * @param [in]myset
 	 * @param [in]noeud
 	 */
-	explicit SetIter(Set<Key, Compare>& myset, typename Set<Key, Compare>::node* noeud) : myset(myset),
-																						  size(myset.getSize()),
-																						  currentNode(noeud) {
+	explicit SetIter(Set<Key, Compare, Allocator>& myset, typename Set<Key, Compare, Allocator>::node* noeud) :
+			myset(myset), size(myset.getSize()), currentNode(noeud) {
 		if (currentNode != myset.tnil) {
 			this->lastNode = currentNode->pere;
 		}
@@ -672,8 +1299,9 @@ public:
 	 * Constructeur par copie.
 	 * @param [in]setIter
 	 */
-	SetIter(const SetIter<Key, Compare>& setIter) : myset(setIter.myset), size(setIter.size),
-													currentNode(setIter.currentNode), lastNode(setIter.lastNode) {}
+	SetIter(const SetIter<Key, Compare, Allocator>& setIter) : myset(setIter.myset), size(setIter.size),
+															   currentNode(setIter.currentNode),
+															   lastNode(setIter.lastNode) {}
 
 	/**
 	 * Destructeur d'itérateur de Set.
@@ -686,7 +1314,7 @@ public:
 	 * @return [out] True s'ils sont égaux, sinon false.
 	 */
 	bool operator==(const SetIter& rhs) const {
-		return (this->currentNode == rhs.currentNode) && (this->lastNode == rhs.lastNode);
+		return this->currentNode == rhs.currentNode;
 	}
 
 	/**
@@ -695,36 +1323,30 @@ public:
 	 * @return [out] True s'ils sont différents, sinon false.
 	 */
 	bool operator!=(const SetIter& rhs) const {
-		return (rhs.currentNode != this->currentNode) && (rhs.lastNode != this->lastNode);
+		return !(*this == rhs);
 	}
 
-	typename Set<Key, Compare>::reference operator*() const {
-		return *this->currentNode->key;
+	typename Set<Key, Compare, Allocator>::reference operator*() const {
+		return this->currentNode->key;
 	}
 
-	typename Set<Key, Compare>::iterator operator++() {
-		/*
-		 * Parcours toujours vers la droite.
-		 */
-		if (this->currentNode->filsDroit != this->myset.tnil) {
-			this->currentNode = this->currentNode->filsDroit;
-			while (this->currentNode->filsGauche != this->myset.tnil)
-				this->currentNode = this->currentNode->filsGauche;
-		} else {
-			typename Set<Key, Compare>::node* pere = this->currentNode->pere;
-			while (this->currentNode == pere->filsDroit) {
-				this->currentNode = pere;
-				pere = pere->pere;
-			}
-			if (this->currentNode->filsDroit != pere)
-				this->currentNode = pere;
-		}
+	typename Set<Key, Compare, Allocator>::iterator& operator++() {
+		this->lastNode = this->currentNode;
+		this->currentNode = this->myset.next_live(this->myset.tree_successor(this->currentNode));
+		return *this;
 	}
 
-	typename Set<Key, Compare>::iterator operator++(int) {
+	typename Set<Key, Compare, Allocator>::iterator operator++(int) {
 
 	}
 };
 
+namespace pmr {
+	/**
+	 * Set dont les nœuds sont alloués par une std::pmr::memory_resource.
+	 */
+	template<typename Key, typename Compare=std::less<Key>>
+	using Set = ::Set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}
 
 #endif //PROJET_SET_HPP
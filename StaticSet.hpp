@@ -0,0 +1,315 @@
+#ifndef PROJET_STATICSET_HPP
+#define PROJET_STATICSET_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Set.hpp"
+
+/**
+ * @class StaticSet
+ * Ensemble figé de N clés, trié et disposé à la compilation selon l'ordre d'Eytzinger (arbre binaire implicite
+ * stocké en largeur : les fils de la case k sont 2k et 2k + 1). Les premiers niveaux, parcourus par toutes les
+ * recherches, tiennent dans quelques lignes de cache ; la descente ne dépend que du résultat de la comparaison,
+ * sans branchement.
+ *
+ * Aucune allocation, aucun coût au démarrage si l'objet est constexpr. Les clés doivent être des types littéraux
+ * constructibles par défaut (entiers, std::string_view...) et deux à deux distinctes.
+ * @authors Florent Denef
+ * @tparam Key Type de clé
+ * @tparam N Nombre de clés
+ * @tparam Compare Type de la fonction de comparaison, utilisable en constexpr
+ */
+template<typename Key, std::size_t N, typename Compare=std::less<Key>>
+class StaticSet {
+/**
+ * @publicsection Types publics.
+ */
+public:
+	using key_type = Key;
+	using value_type = Key;
+	using key_compare = Compare;
+	using size_type = std::size_t;
+	using const_reference = const value_type&;
+	using const_iterator = const value_type*;
+/**
+ * @privatesection
+ */
+private:
+	std::array<Key, N + 1> cases{}; ///< Disposition d'Eytzinger, la case 0 est inutilisée.
+	key_compare keyComp;
+
+	/**
+	 * @return La case du plus petit élément dans la disposition d'Eytzinger, 0 si N = 0.
+	 */
+	static constexpr size_type premier() noexcept {
+		if (N == 0)
+			return 0;
+		size_type k = 1;
+		while (2 * k <= N)
+			k *= 2;
+		return k;
+	}
+
+	/**
+	 * @return Nombre de niveaux de l'arbre implicite (log2(N) + 1, 0 si N = 0).
+	 */
+	static constexpr size_type hauteur() noexcept {
+		size_type h = 0;
+		for (size_type n = N; n != 0; n >>= 1)
+			++h;
+		return h;
+	}
+
+	/**
+	 * Nombre de 1 de poids faible de k.
+	 * @param [in]k Valeur dont on compte les 1 terminaux, k != ~0.
+	 * @return Le nombre de 1 consécutifs à partir du bit 0.
+	 */
+	static constexpr size_type uns_terminaux(size_type k) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_type>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+		size_type n = 0;
+		for (; k & 1; k >>= 1)
+			++n;
+		return n;
+#endif
+	}
+
+	/**
+	 * Successeur infixe dans l'arbre implicite.
+	 * @param [in]k Case courante.
+	 * @return La case suivante dans l'ordre croissant, 0 après la dernière.
+	 */
+	static constexpr size_type suivant(size_type k) noexcept {
+		if (2 * k + 1 <= N) {
+			k = 2 * k + 1;
+			while (2 * k <= N)
+				k *= 2;
+			return k;
+		}
+		while (k & 1)
+			k >>= 1;
+		return k >> 1;
+	}
+
+	/**
+	 * Tamisage du tri par tas.
+	 * @param [in,out]t Tableau à trier.
+	 * @param [in]i Racine du sous-tas.
+	 * @param [in]n Taille du tas.
+	 */
+	constexpr void tamiser(std::array<Key, N>& t, size_type i, size_type n) const {
+		while (2 * i + 1 < n) {
+			size_type fils = 2 * i + 1;
+			if (fils + 1 < n && keyComp(t[fils], t[fils + 1]))
+				++fils;
+			if (!keyComp(t[i], t[fils]))
+				return;
+			Key tmp = t[i];
+			t[i] = t[fils];
+			t[fils] = tmp;
+			i = fils;
+		}
+	}
+
+	/**
+	 * Trie les clés (tri par tas, O(N log N) aussi à la compilation) puis les range dans la disposition d'Eytzinger.
+	 * @param [in]t Clés dans un ordre quelconque.
+	 * @throw std::invalid_argument Si deux clés sont équivalentes (erreur de compilation en contexte constexpr).
+	 */
+	constexpr void disposer(std::array<Key, N> t) {
+		for (size_type i = N / 2; i-- > 0;)
+			tamiser(t, i, N);
+		for (size_type n = N; n > 1; --n) {
+			Key tmp = t[0];
+			t[0] = t[n - 1];
+			t[n - 1] = tmp;
+			tamiser(t, 0, n - 1);
+		}
+		for (size_type i = 1; i < N; ++i)
+			if (!keyComp(t[i - 1], t[i]))
+				throw std::invalid_argument("StaticSet : cles en double");
+		size_type k = premier();
+		for (size_type i = 0; i < N; ++i, k = suivant(k))
+			cases[k] = t[i];
+	}
+
+	/**
+	 * Recherche sans branchement dépendant de la clé : la descente fait toujours hauteur() pas de
+	 * k = 2k + (cases[k] < key), un chemin sorti de l'arbre restant sur place (sélection par masque, la case 0
+	 * servant de lecture factice). Le dernier virage à gauche, plus petit élément >= key, s'obtient ensuite en un seul
+	 * décalage : k >> (nombre de 1 terminaux + 1).
+	 * @param [in]key Clé à trouver.
+	 * @return [out] La case de la clé, ou 0 si elle est absente.
+	 */
+	constexpr size_type indice(const Key& key) const {
+		size_type k = 1;
+		for (size_type niveau = 0; niveau < hauteur(); ++niveau) {
+			const size_type dedans = k <= N;
+			const size_type masque = size_type(0) - dedans;
+			const size_type fils = 2 * k + static_cast<size_type>(keyComp(cases[k & masque], key));
+			k = (fils & masque) | (k & ~masque);
+		}
+		k >>= uns_terminaux(k) + 1;
+		const size_type trouve = (k != 0) & !keyComp(key, cases[k]);
+		return k & (size_type(0) - trouve);
+	}
+
+/**
+ * @publicsection
+ */
+public:
+	/**
+	 * Construit l'ensemble à partir d'un tableau de clés distinctes, dans un ordre quelconque.
+	 * @param [in]keys Clés.
+	 * @param [in]comp Comparateur.
+	 */
+	constexpr explicit StaticSet(const std::array<Key, N>& keys, const key_compare& comp = key_compare()) :
+			keyComp(comp) {
+		disposer(keys);
+	}
+
+	/**
+	 * Construit l'ensemble à partir d'un tableau C (ou d'une liste entre accolades) de valeurs convertibles en Key,
+	 * par exemple des littéraux chaînes pour des std::string_view.
+	 * Absent pour N = 0 (pas de tableau C de taille nulle) : utiliser le constructeur par std::array.
+	 * @tparam T Type des éléments du tableau.
+	 * @tparam M Taille du tableau, égale à N.
+	 * @param [in]keys Clés.
+	 * @param [in]comp Comparateur.
+	 */
+	template<typename T, std::size_t M, typename = typename std::enable_if<M == N && M != 0>::type>
+	constexpr explicit StaticSet(const T (& keys)[M], const key_compare& comp = key_compare()) : keyComp(comp) {
+		std::array<Key, N> t{};
+		for (size_type i = 0; i < N; ++i)
+			t[i] = Key(keys[i]);
+		disposer(t);
+	}
+
+	/**
+	 * Conversion depuis un Set, en O(N) : ses éléments vivants sont déjà triés.
+	 * @param [in]s Set source.
+	 * @throw std::length_error Si s ne contient pas exactement N éléments.
+	 */
+	template<typename Allocator>
+	explicit StaticSet(const Set<Key, Compare, Allocator>& s) : keyComp(s.keyComp) {
+		if (s.getSize() != N)
+			throw std::length_error("StaticSet : le Set n'a pas N elements");
+		size_type k = premier();
+		for (auto x = s.next_live(s.plusPetit); x != s.tnil; x = s.next_live(s.tree_successor(x)), k = suivant(k))
+			cases[k] = x->key;
+	}
+
+	/**
+	 * Conversion vers un Set, en O(N) : les nœuds sont créés dans l'ordre croissant puis chaînés par rebuild.
+	 * @tparam Allocator Allocateur du Set.
+	 * @param [in]a Allocateur.
+	 * @return [out] Un Set contenant les N clés.
+	 */
+	template<typename Allocator=std::allocator<Key>>
+	Set<Key, Compare, Allocator> toSet(const Allocator& a = Allocator()) const {
+		Set<Key, Compare, Allocator> s(keyComp, a);
+		std::vector<typename Set<Key, Compare, Allocator>::node*> nodes;
+		nodes.reserve(N);
+		try {
+			for (size_type k = premier(); k != 0; k = suivant(k))
+				nodes.push_back(s.create_node(cases[k]));
+		} catch (...) {
+			for (auto n : nodes)
+				s.destroy_node(n);
+			throw;
+		}
+		s.rebuild(nodes);
+		return s;
+	}
+
+	/**
+	 * Conversion implicite vers un Set utilisant std::allocator.
+	 */
+	operator Set<Key, Compare>() const { return toSet(); }
+
+	/**
+	 * @param [in]key Clé à trouver.
+	 * @return [out] Pointeur sur la clé, ou end() si elle est absente.
+	 */
+	constexpr const_iterator find(const Key& key) const {
+		const size_type k = indice(key);
+		return k != 0 ? cases.data() + k : end();
+	}
+
+	/**
+	 * @param [in]key Clé à trouver.
+	 * @return [out] True si la clé est présente.
+	 */
+	constexpr bool contains(const Key& key) const { return indice(key) != 0; }
+
+	/**
+	 * @param [in]key Clé à trouver.
+	 * @return [out] 1 si la clé est présente, 0 sinon.
+	 */
+	constexpr size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+	/**
+	 * Début du stockage : les clés y sont dans l'ordre d'Eytzinger, pas dans l'ordre croissant.
+	 * @return [out] Pointeur sur la première clé stockée.
+	 */
+	constexpr const_iterator begin() const noexcept { return cases.data() + 1; }
+
+	/**
+	 * @return [out] Pointeur après la dernière clé stockée.
+	 */
+	constexpr const_iterator end() const noexcept { return cases.data() + N + 1; }
+
+	/**
+	 * @return [out] Nombre de clés.
+	 */
+	static constexpr size_type size() noexcept { return N; }
+
+	/**
+	 * @return [out] True si N = 0.
+	 */
+	static constexpr bool empty() noexcept { return N == 0; }
+
+	/**
+	 * @return [out] Fonction de comparaison de l'objet courant.
+	 */
+	constexpr key_compare key_comp() const { return keyComp; }
+};
+
+/**
+ * Type de clé déduit d'un type d'élément : les pointeurs sur char (littéraux chaînes) deviennent des
+ * std::string_view, pour comparer le contenu des chaînes et non leurs adresses.
+ */
+template<typename T>
+struct StaticSetKey {
+	using type = T;
+};
+
+template<>
+struct StaticSetKey<const char*> {
+	using type = std::string_view;
+};
+
+template<>
+struct StaticSetKey<char*> {
+	using type = std::string_view;
+};
+
+/**
+ * Guides de déduction : StaticSet s({3, 1, 2}) donne StaticSet<int, 3> et StaticSet s({"if", "else"}) donne
+ * StaticSet<std::string_view, 2>. Tout autre type de clé chaîne (std::string ne pouvant être constexpr) doit être
+ * écrit explicitement, par exemple StaticSet<std::string_view, 5, MonComparateur>.
+ */
+template<typename T, std::size_t N>
+StaticSet(const T (&)[N]) -> StaticSet<typename StaticSetKey<T>::type, N>;
+
+template<typename T, std::size_t N>
+StaticSet(const std::array<T, N>&) -> StaticSet<typename StaticSetKey<T>::type, N>;
+
+#endif //PROJET_STATICSET_HPP
@@ -0,0 +1,99 @@
+/**
+ * Banc d'essai « file de priorité » : n échéances initiales, puis des cycles « retirer la plus proche, en planifier
+ * une nouvelle plus tard ». Compare Set::pop_front à l'ancienne méthode (begin + erase), std::priority_queue et
+ * std::set.
+ * Usage : bench-queue [n] [cycles]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+#include "Set.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Exécute f et affiche sa durée.
+ * @param [in]nom Nom de la mesure.
+ * @param [in]f Fonction mesurée, renvoie une somme de contrôle.
+ */
+template<typename F>
+void mesure(const char* nom, F f) {
+	const auto debut = Clock::now();
+	const unsigned long long controle = f();
+	const auto ms = std::chrono::duration<double, std::milli>(Clock::now() - debut).count();
+	std::printf("%-28s %10.2f ms  (controle %llu)\n", nom, ms, controle);
+}
+
+int main(int argc, char** argv) {
+	const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+	const size_t cycles = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+	// Échéances distinctes : les 20 bits de poids faible portent un numéro de séquence.
+	std::vector<unsigned long long> initiales(n), delais(cycles);
+	std::mt19937_64 generateur(42);
+	std::uniform_int_distribution<unsigned long long> distribution(1, 1u << 20);
+	for (size_t i = 0; i < n; ++i)
+		initiales[i] = (distribution(generateur) << 20) | (i & 0xFFFFF);
+	for (auto& d : delais)
+		d = distribution(generateur) << 20;
+	auto suivante = [&](unsigned long long courante, size_t i) {
+		return ((courante >> 20 << 20) + delais[i]) | ((n + i) & 0xFFFFF);
+	};
+
+	std::printf("n = %zu, cycles = %zu\n", n, cycles);
+	mesure("Set::pop_front", [&] {
+		Set<unsigned long long> file;
+		for (auto e : initiales)
+			file.insert(e);
+		unsigned long long controle = 0;
+		for (size_t i = 0; i < cycles; ++i) {
+			const unsigned long long courante = file.front();
+			file.pop_front();
+			controle += courante;
+			file.insert(suivante(courante, i));
+		}
+		return controle;
+	});
+	mesure("Set begin + erase", [&] {
+		Set<unsigned long long> file;
+		for (auto e : initiales)
+			file.insert(e);
+		unsigned long long controle = 0;
+		for (size_t i = 0; i < cycles; ++i) {
+			const unsigned long long courante = *file.begin();
+			file.erase(courante);
+			controle += courante;
+			file.insert(suivante(courante, i));
+		}
+		return controle;
+	});
+	mesure("std::priority_queue", [&] {
+		std::priority_queue<unsigned long long, std::vector<unsigned long long>, std::greater<unsigned long long>> file(
+				std::greater<unsigned long long>(), initiales);
+		unsigned long long controle = 0;
+		for (size_t i = 0; i < cycles; ++i) {
+			const unsigned long long courante = file.top();
+			file.pop();
+			controle += courante;
+			file.push(suivante(courante, i));
+		}
+		return controle;
+	});
+	mesure("std::set", [&] {
+		std::set<unsigned long long> file(initiales.begin(), initiales.end());
+		unsigned long long controle = 0;
+		for (size_t i = 0; i < cycles; ++i) {
+			const unsigned long long courante = *file.begin();
+			file.erase(file.begin());
+			controle += courante;
+			file.insert(suivante(courante, i));
+		}
+		return controle;
+	});
+	return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * Banc d'essai des recherches : StaticSet (construit à la compilation) contre Set::find, std::set::find et
+ * std::binary_search sur un tableau trié, pour une table de 4096 clés et moitié de recherches fructueuses.
+ * Usage : bench-static [recherches]
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+#include "StaticSet.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t taille = 4096;
+
+/**
+ * Table de clés paires distinctes, dans un ordre mélangé (multiplication par un nombre premier avec taille).
+ */
+constexpr std::array<int, taille> table() {
+	std::array<int, taille> t{};
+	for (std::size_t i = 0; i < taille; ++i)
+		t[i] = static_cast<int>((i * 2654435761u) % taille) * 2;
+	return t;
+}
+
+constexpr StaticSet<int, taille> statique(table());
+
+/**
+ * Exécute f et affiche sa durée.
+ * @param [in]nom Nom de la mesure.
+ * @param [in]f Fonction mesurée, renvoie le nombre de clés trouvées.
+ */
+template<typename F>
+void mesure(const char* nom, F f) {
+	const auto debut = Clock::now();
+	const std::size_t trouves = f();
+	const auto ms = std::chrono::duration<double, std::milli>(Clock::now() - debut).count();
+	std::printf("%-24s %10.2f ms  (trouves %zu)\n", nom, ms, trouves);
+}
+
+int main(int argc, char** argv) {
+	const std::size_t recherches = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+	std::vector<int> cles(recherches);
+	std::mt19937 generateur(42);
+	std::uniform_int_distribution<int> distribution(0, 2 * static_cast<int>(taille) - 1);
+	for (auto& c : cles)
+		c = distribution(generateur);
+
+	Set<int> dynamique = statique;
+	std::set<int> stl(statique.begin(), statique.end());
+	std::vector<int> trie(statique.begin(), statique.end());
+	std::sort(trie.begin(), trie.end());
+
+	std::printf("%zu cles, %zu recherches\n", taille, recherches);
+	mesure("StaticSet::contains", [&] {
+		std::size_t trouves = 0;
+		for (int c : cles)
+			trouves += statique.contains(c);
+		return trouves;
+	});
+	mesure("Set::find", [&] {
+		std::size_t trouves = 0;
+		for (int c : cles)
+			trouves += dynamique.find(c) != dynamique.end();
+		return trouves;
+	});
+	mesure("std::set::find", [&] {
+		std::size_t trouves = 0;
+		for (int c : cles)
+			trouves += stl.find(c) != stl.end();
+		return trouves;
+	});
+	mesure("std::binary_search", [&] {
+		std::size_t trouves = 0;
+		for (int c : cles)
+			trouves += std::binary_search(trie.begin(), trie.end(), c);
+		return trouves;
+	});
+	return 0;
+}
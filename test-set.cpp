@@ -2,7 +2,12 @@
 #include <set>
 #include <chrono>
 #include <random>
+#include <string>
+#include <cctype>
+#include <memory_resource>
+#include <string_view>
 #include "Set.hpp"
+#include "StaticSet.hpp"
 
 TEST_CASE("Test constructeur", "[1][constructeur test]") {
 	std::set<int> stlSet;
@@ -44,4 +49,414 @@ TEST_CASE("Test iterator ++", "[3][test insertion iterateur ++]") {
 		 iterstl != stlSet.end() && iterSet != mySet.end(); ++iterstl, ++iterSet) {
 		REQUIRE((*iterSet) == (*iterstl));
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Test erase_if", "[4][test erase_if]") {
+	Set<int> mySet;
+	std::set<int> stlSet;
+	for (int i = 0; i < 1000; ++i) {
+		int number = (i * 7919) % 1000;
+		mySet.insert(number);
+		stlSet.insert(number);
+	}
+	SECTION("Peu de suppressions : effacement en place") {
+		auto pred = [](const int& v) { return v % 100 == 0; };
+		REQUIRE(mySet.erase_if(pred) == 10);
+		for (auto it = stlSet.begin(); it != stlSet.end();)
+			it = pred(*it) ? stlSet.erase(it) : std::next(it);
+	}
+	SECTION("Beaucoup de suppressions : reconstruction") {
+		auto pred = [](const int& v) { return v % 3 != 0; };
+		REQUIRE(mySet.erase_if(pred) == 666);
+		for (auto it = stlSet.begin(); it != stlSet.end();)
+			it = pred(*it) ? stlSet.erase(it) : std::next(it);
+	}
+	SECTION("Tout effacer") {
+		REQUIRE(mySet.erase_if([](const int&) { return true; }) == 1000);
+		stlSet.clear();
+		REQUIRE(mySet.empty());
+	}
+	REQUIRE(mySet.getSize() == stlSet.size());
+	auto iterSet = mySet.begin();
+	for (auto iterstl = stlSet.begin(); iterstl != stlSet.end(); ++iterstl, ++iterSet) {
+		REQUIRE(iterSet != mySet.end());
+		REQUIRE((*iterSet) == (*iterstl));
+	}
+	REQUIRE(iterSet == mySet.end());
+	int absent = -1;
+	mySet.insert(absent);
+	REQUIRE(mySet.find(absent) != mySet.end());
+	REQUIRE(mySet.erase(absent) == 1);
+	REQUIRE(mySet.getSize() == stlSet.size());
+}
+
+TEST_CASE("Test effacement paresseux", "[5][test effacement paresseux]") {
+	Set<int> mySet;
+	std::set<int> stlSet;
+	for (int i = 0; i < 100; ++i) {
+		mySet.insert(i);
+		stlSet.insert(i);
+	}
+	mySet.setLazyErase(true);
+	mySet.setCompactionThreshold(0.25);
+	REQUIRE(mySet.isLazyErase());
+	for (int i = 0; i < 100; i += 5) {
+		REQUIRE(mySet.erase(i) == 1);
+		REQUIRE(mySet.erase(i) == 0);
+		stlSet.erase(i);
+	}
+	REQUIRE(mySet.getLiveCount() == 80);
+	REQUIRE(mySet.getDeadCount() == 20);
+	REQUIRE(mySet.getDeadRatio() == Approx(0.2));
+	int mort = 10, vivant = 11;
+	REQUIRE(mySet.find(mort) == mySet.end());
+	REQUIRE(mySet.find(vivant) != mySet.end());
+	auto iterSet = mySet.begin();
+	for (auto iterstl = stlSet.begin(); iterstl != stlSet.end(); ++iterstl, ++iterSet)
+		REQUIRE((*iterSet) == (*iterstl));
+	REQUIRE(iterSet == mySet.end());
+
+	SECTION("Résurrection") {
+		REQUIRE(mySet.insert(mort).second);
+		REQUIRE_FALSE(mySet.insert(mort).second);
+		REQUIRE(mySet.getDeadCount() == 19);
+		REQUIRE(mySet.getLiveCount() == 81);
+		REQUIRE(mySet.find(mort) != mySet.end());
+	}
+	SECTION("Compaction au seuil") {
+		for (int i = 1; i < 100 && mySet.getDeadCount() != 0; i += 5)
+			mySet.erase(i);
+		REQUIRE(mySet.getDeadCount() == 0);
+		REQUIRE(mySet.getLiveCount() == 74);
+	}
+	SECTION("Compaction explicite") {
+		mySet.compact();
+		REQUIRE(mySet.getDeadCount() == 0);
+		REQUIRE(mySet.getLiveCount() == 80);
+		REQUIRE(mySet.erase_if([](const int& v) { return v < 50; }) == 40);
+		REQUIRE(mySet.getSize() == 40);
+	}
+}
+
+/**
+ * Ressource comptant les allocations et libérations, au-dessus de la ressource par défaut.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+	size_t allocations = 0, liberations = 0;
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		++liberations;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST_CASE("Test pmr", "[6][test pmr]") {
+	CountingResource compteur;
+	SECTION("Toutes les allocations passent par la ressource") {
+		{
+			pmr::Set<std::pmr::string> mySet(&compteur);
+			for (int i = 0; i < 100; ++i)
+				mySet.insert(std::pmr::string(std::to_string(i * 1000000007LL), &compteur));
+			REQUIRE(mySet.getSize() == 100);
+			REQUIRE(mySet.erase_if([](const std::pmr::string& v) { return v.size() % 2 == 0; }) > 0);
+		}
+		REQUIRE(compteur.allocations > 100);
+		REQUIRE(compteur.allocations == compteur.liberations);
+	}
+	SECTION("Ressource monotone") {
+		std::pmr::monotonic_buffer_resource monotone(&compteur);
+		{
+			pmr::Set<int> mySet(&monotone);
+			for (int i = 0; i < 1000; ++i)
+				mySet.insert(i);
+			mySet.clear();
+			REQUIRE(mySet.empty());
+			REQUIRE(mySet.begin() == mySet.end());
+			mySet.insert({1, 2, 3});
+			REQUIRE(mySet.getSize() == 3);
+		}
+		REQUIRE(compteur.liberations == 0);
+		monotone.release();
+		REQUIRE(compteur.allocations == compteur.liberations);
+	}
+	SECTION("Propagation de l'allocateur") {
+		CountingResource autre;
+		pmr::Set<int> a(&compteur), b(&autre);
+		a.insert({1, 2, 3});
+		b.insert({4, 5});
+		pmr::Set<int> copie(a);
+		REQUIRE(copie.get_allocator().resource() == std::pmr::get_default_resource());
+		REQUIRE(copie.getSize() == 3);
+		pmr::Set<int> deplace(std::move(copie));
+		REQUIRE(deplace.get_allocator().resource() == std::pmr::get_default_resource());
+		REQUIRE(deplace.getSize() == 3);
+		b = a;
+		REQUIRE(b.get_allocator().resource() == &autre);
+		REQUIRE(b.getSize() == 3);
+		b.insert({4, 5});
+		a.swap(b);
+		REQUIRE(a.get_allocator().resource() == &compteur);
+		REQUIRE(b.get_allocator().resource() == &autre);
+		REQUIRE(a.getSize() == 5);
+		REQUIRE(b.getSize() == 3);
+		b = std::move(a);
+		REQUIRE(b.get_allocator().resource() == &autre);
+		REQUIRE(b.getSize() == 5);
+	}
+}
+
+/**
+ * Type de clé utilisateur avec une spécialisation de SetKeyPrefix.
+ */
+struct Point {
+	int x, y;
+};
+
+/**
+ * Comparateur lexicographique comptant ses appels.
+ */
+struct ComparePoint {
+	static size_t appels;
+
+	bool operator()(const Point& a, const Point& b) const {
+		++appels;
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	}
+};
+
+size_t ComparePoint::appels = 0;
+
+template<>
+struct SetKeyPrefix<Point, ComparePoint> {
+	static constexpr bool enabled = true;
+	using prefix_type = std::uint32_t;
+
+	static prefix_type prefix(const Point& p) noexcept { return static_cast<prefix_type>(p.x) ^ 0x80000000u; }
+};
+
+TEST_CASE("Test préfixe de clé", "[7][test prefixe]") {
+	SECTION("Chaînes") {
+		Set<std::string> mySet;
+		std::set<std::string> stlSet;
+		const std::string mots[] = {"", "a", "ab", "abcdefgh", "abcdefghi", "abcdefgh\x01", "abcdefgg~", "b",
+									std::string("a\0b", 3), "\xff\xfe", "zzzzzzzzzzzzzzzz", "abcdefghij"};
+		for (const auto& mot : mots) {
+			REQUIRE(mySet.insert(mot).second == stlSet.insert(mot).second);
+		}
+		REQUIRE_FALSE(mySet.insert(std::string("abcdefghi")).second);
+		auto iterSet = mySet.begin();
+		for (auto iterstl = stlSet.begin(); iterstl != stlSet.end(); ++iterstl, ++iterSet)
+			REQUIRE((*iterSet) == (*iterstl));
+		for (const auto& mot : mots)
+			REQUIRE(mySet.find(mot) != mySet.end());
+		REQUIRE(mySet.find(std::string("abcdefghk")) == mySet.end());
+	}
+	SECTION("Spécialisation utilisateur") {
+		Set<Point, ComparePoint> mySet;
+		for (int i = 0; i < 100; ++i)
+			mySet.insert(Point{(i * 37) % 100 - 50, i});
+		REQUIRE(ComparePoint::appels == 0);
+		REQUIRE(mySet.find(Point{-50, 0}) != mySet.end());
+		REQUIRE(ComparePoint::appels == 2);
+		REQUIRE(mySet.find(Point{-50, 1}) == mySet.end());
+		int precedent = -51;
+		for (auto it = mySet.begin(); it != mySet.end(); ++it) {
+			REQUIRE((*it).x > precedent);
+			precedent = (*it).x;
+		}
+	}
+}
+
+TEST_CASE("Test file de priorité", "[8][test front back pop]") {
+	Set<int> mySet;
+	std::set<int> stlSet;
+	std::default_random_engine generator(
+			static_cast<unsigned long>(std::chrono::system_clock::now().time_since_epoch().count()));
+	std::uniform_int_distribution<> distribution(0, 10000);
+	for (int i = 0; i < 500; ++i) {
+		int number = distribution(generator);
+		mySet.insert(number);
+		stlSet.insert(number);
+	}
+	mySet.setLazyErase(true);
+	for (int i = 0; i < 2000 && !stlSet.empty(); ++i) {
+		REQUIRE(mySet.front() == *stlSet.begin());
+		REQUIRE(mySet.back() == *stlSet.rbegin());
+		int number = distribution(generator);
+		switch (i % 4) {
+			case 0:
+				mySet.pop_front();
+				stlSet.erase(stlSet.begin());
+				break;
+			case 1:
+				mySet.pop_back();
+				stlSet.erase(std::prev(stlSet.end()));
+				break;
+			case 2:
+				mySet.erase(number);
+				stlSet.erase(number);
+				break;
+			default:
+				mySet.insert(number);
+				stlSet.insert(number);
+		}
+		REQUIRE(mySet.getSize() == stlSet.size());
+	}
+	mySet.clear();
+	REQUIRE(mySet.begin() == mySet.end());
+	int number = 42;
+	mySet.insert(number);
+	REQUIRE(mySet.front() == 42);
+	REQUIRE(mySet.back() == 42);
+	mySet.pop_back();
+	REQUIRE(mySet.empty());
+}
+
+TEST_CASE("Test StaticSet", "[9][test static set]") {
+	static constexpr StaticSet<int, 7> codes({404, 200, 301, 500, 302, 201, 418});
+	static_assert(codes.contains(418), "recherche à la compilation");
+	static_assert(!codes.contains(999), "recherche à la compilation");
+	static_assert(codes.size() == 7, "taille");
+
+	static constexpr StaticSet<std::string_view, 5> reserves({"while", "for", "if", "else", "return"});
+	REQUIRE(reserves.contains("return"));
+	REQUIRE_FALSE(reserves.contains("goto"));
+	REQUIRE(*reserves.find("if") == "if");
+	REQUIRE(reserves.find("do") == reserves.end());
+
+	static constexpr StaticSet mots({"si", "sinon", "tantque"});
+	static_assert(std::is_same<decltype(mots)::key_type, std::string_view>::value, "littéraux -> string_view");
+	static_assert(mots.contains("sinon") && !mots.contains("pour"), "comparaison du contenu");
+	const char tampon[] = "si";
+	REQUIRE(mots.contains(tampon));
+
+	constexpr StaticSet<int, 0> vide(std::array<int, 0>{});
+	REQUIRE_FALSE(vide.contains(0));
+
+	for (int n = 0; n < 600; ++n)
+		REQUIRE(codes.count(n) == (n == 200 || n == 201 || n == 301 || n == 302 || n == 404 || n == 418 || n == 500));
+
+	SECTION("Conversion vers et depuis Set") {
+		Set<int> mySet = codes;
+		REQUIRE(mySet.getSize() == 7);
+		REQUIRE(mySet.front() == 200);
+		REQUIRE(mySet.back() == 500);
+		std::set<int> stlSet(codes.begin(), codes.end());
+		auto iterSet = mySet.begin();
+		for (auto iterstl = stlSet.begin(); iterstl != stlSet.end(); ++iterstl, ++iterSet)
+			REQUIRE((*iterSet) == (*iterstl));
+		REQUIRE(mySet.erase(404) == 1);
+		REQUIRE_THROWS_AS((StaticSet<int, 7>(mySet)), std::length_error);
+		mySet.insert(100);
+		StaticSet<int, 7> retour(mySet);
+		REQUIRE(retour.contains(100));
+		REQUIRE_FALSE(retour.contains(404));
+		for (int code : {200, 201, 301, 302, 418, 500})
+			REQUIRE(retour.contains(code));
+	}
+}
+
+TEST_CASE("Test affectation dans un Set déplacé", "[10][test affectation deplace]") {
+	Set<int> a;
+	a.insert(1);
+	Set<int> b(std::move(a));
+	REQUIRE(b.getSize() == 1);
+	Set<int> vide;
+	a = vide;
+	REQUIRE(a.empty());
+	REQUIRE(a.begin() == a.end());
+	REQUIRE(a.erase_if([](const int&) { return true; }) == 0);
+	a.insert(3);
+	a.insert(2);
+	REQUIRE(a.front() == 2);
+	REQUIRE(a.back() == 3);
+	Set<int> c(std::move(b));
+	b = std::move(vide);
+	REQUIRE(b.begin() == b.end());
+	b.insert(5);
+	REQUIRE(b.front() == 5);
+}
+
+TEST_CASE("Test Set déplacé", "[11][test set deplace]") {
+	Set<int> a;
+	a.insert(1);
+	Set<int> b(std::move(a));
+	REQUIRE(a.empty());
+	REQUIRE(a.begin() == a.end());
+	REQUIRE(a.find(1) == a.end());
+	REQUIRE(a.erase(1) == 0);
+	REQUIRE(a.erase_if([](const int&) { return true; }) == 0);
+	a.clear();
+	Set<int> copie(a);
+	REQUIRE(copie.empty());
+	REQUIRE(a.insert(2).second);
+	REQUIRE(a.find(2) != a.end());
+	REQUIRE(a.front() == 2);
+	REQUIRE(b.front() == 1);
+	Set<int> c(std::move(a));
+	a.swap(b);
+	REQUIRE(a.front() == 1);
+	REQUIRE(b.empty());
+	REQUIRE(b.insert(7).second);
+	REQUIRE(b.getSize() == 1);
+}
+
+/**
+ * Comparateur insensible à la casse : "Foo" et "foo" sont équivalents.
+ */
+struct CompareSansCasse {
+	bool operator()(const std::string& a, const std::string& b) const {
+		for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+			const int ca = std::tolower(static_cast<unsigned char>(a[i]));
+			const int cb = std::tolower(static_cast<unsigned char>(b[i]));
+			if (ca != cb)
+				return ca < cb;
+		}
+		return a.size() < b.size();
+	}
+};
+
+TEST_CASE("Test résurrection avec une valeur équivalente", "[12][test resurrection valeur]") {
+	for (bool paresseux : {false, true}) {
+		Set<std::string, CompareSansCasse> mySet;
+		mySet.setLazyErase(paresseux);
+		mySet.setCompactionThreshold(1.0);
+		const std::string foo = "foo";
+		mySet.insert(std::string("Foo"));
+		REQUIRE(mySet.erase(foo) == 1);
+		REQUIRE(mySet.insert(foo).second);
+		REQUIRE(*mySet.find(foo) == "foo");
+		REQUIRE(mySet.erase(std::string("FOO")) == 1);
+		REQUIRE(mySet.insert(std::string("fOo")).second);
+		REQUIRE(*mySet.find(foo) == "fOo");
+		REQUIRE(mySet.getSize() == 1);
+		REQUIRE(mySet.getDeadCount() == 0);
+	}
+}
+
+TEST_CASE("Test affectation par déplacement dans un pmr::Set déplacé", "[13][test affectation deplace pmr]") {
+	CountingResource compteur;
+	pmr::Set<int> a(&compteur);
+	for (int i = 0; i < 100; ++i)
+		a.insert(i);
+	pmr::Set<int> b(std::move(a));
+	pmr::Set<int> c(&compteur);
+	for (int i = 0; i < 1000; ++i)
+		c.insert(i);
+	const size_t allocations = compteur.allocations;
+	a = std::move(c);
+	REQUIRE(compteur.allocations == allocations);
+	REQUIRE(a.getSize() == 1000);
+	REQUIRE(a.front() == 0);
+	REQUIRE(a.back() == 999);
+	REQUIRE(b.getSize() == 100);
+	c.insert(7);
+	REQUIRE(c.getSize() == 1);
+}